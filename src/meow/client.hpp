@@ -8,10 +8,6 @@
 
 namespace meow::net {
 
-    struct Token {
-        uint64_t value;
-    };
-
     struct Profile {
         std::string username;
         std::string email;
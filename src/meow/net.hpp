@@ -4,4 +4,6 @@
 
 #include <meow/net/message.hpp>
 #include <meow/net/connection.hpp>
-#include <meow/net/tsqueue.hpp>
\ No newline at end of file
+#include <meow/net/tsqueue.hpp>
+#include <meow/net/shardedmap.hpp>
+#include <meow/net/session.hpp>
\ No newline at end of file
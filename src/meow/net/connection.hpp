@@ -8,6 +8,7 @@
 #include <meow/net/tsqueue.hpp>
 #include <meow/net/message.hpp>
 
+#include <functional>
 #include <thread>
 #include <string>
 #include <iostream>
@@ -32,6 +33,7 @@ namespace meow::net {
         TSQueue<Message<MessageId>> msgOutQueue;
         TSQueue<OwnedMessage<MessageId>> &msgInQueue;
         Message<MessageId> msgBuffer;
+        std::function<void(const Connection *)> onClose;
 
     public:
         Connection(Owner owner, asio::io_context &io_context, asio::ip::tcp::socket socket,
@@ -41,6 +43,9 @@ namespace meow::net {
 
         bool isConnected() const { return socket.is_open(); }
 
+        // Called on the io thread once the socket has been closed, whichever side closed it
+        void set_on_close(std::function<void(const Connection *)> callback) { onClose = std::move(callback); }
+
         void connect_to_client() {
             if (owner == Owner::Server) {
                 if (isConnected()) {
@@ -66,7 +71,7 @@ namespace meow::net {
 
         void disconnect() {
             if (isConnected()) {
-                asio::post(io_context, [this]() { socket.close(); });
+                asio::post(io_context, [this]() { close(); });
             }
         }
 
@@ -96,7 +101,7 @@ namespace meow::net {
                         }
                     } else {
                         std::cout << "[ERROR] Write header error: " << ec.message() << std::endl;
-                        socket.close();
+                        close();
                     }
                 });
         }
@@ -112,7 +117,7 @@ namespace meow::net {
                                       }
                                   } else {
                                       std::cout << "[ERROR] Write body error: " << ec.message() << std::endl;
-                                      socket.close();
+                                      close();
                                   }
                               });
         }
@@ -129,7 +134,7 @@ namespace meow::net {
                                      }
                                  } else {
                                      std::cout << "[ERROR] Read header error: " << ec.message() << std::endl;
-                                     socket.close();
+                                     close();
                                  }
                              });
         }
@@ -141,11 +146,20 @@ namespace meow::net {
                                      add_to_message_in_queue();
                                  } else {
                                      std::cout << "[ERROR] Read body error: " << ec.message() << std::endl;
-                                     socket.close();
+                                     close();
                                  }
                              });
         }
 
+        void close() {
+            if (isConnected()) {
+                socket.close();
+                if (onClose) {
+                    onClose(this);
+                }
+            }
+        }
+
         void add_to_message_in_queue() {
             if (owner == Owner::Server) {
                 msgInQueue.emplace_back({this->shared_from_this(), msgBuffer});
@@ -0,0 +1,124 @@
+// Session
+// Binds an authenticated token and arbitrary session data to a connection.
+// Sessions are indexed both by token and by connection, so a handler can go
+// from either one to the other without decoding the message body again.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <meow/net/shardedmap.hpp>
+
+#include <any>
+#include <memory>
+#include <mutex>
+
+namespace meow::net {
+
+    struct Token {
+        uint64_t value;
+
+        friend bool operator==(const Token &lhs, const Token &rhs) { return lhs.value == rhs.value; }
+        friend bool operator!=(const Token &lhs, const Token &rhs) { return !(lhs == rhs); }
+    };
+
+    struct TokenHash {
+        size_t operator()(const Token &token) const { return std::hash<uint64_t>()(token.value); }
+    };
+
+    class Connection;
+
+    // Data is set once on login; handlers that mutate it afterwards must
+    // bring their own synchronisation. The connection is held weakly so a
+    // session never keeps a closed socket alive.
+    struct Session {
+        Token token;
+        std::weak_ptr<Connection> connection;
+        std::any data;
+
+        template <typename T>
+        T *get() {
+            return std::any_cast<T>(&data);
+        }
+
+        template <typename T>
+        const T *get() const {
+            return std::any_cast<T>(&data);
+        }
+    };
+
+    class SessionStore {
+    protected:
+        // The token index remembers which connection key it was bound under,
+        // so the entry can still be erased after the connection has expired
+        struct Binding {
+            const Connection *connection;
+            std::shared_ptr<Session> session;
+        };
+
+        ShardedMap<Token, Binding, TokenHash> byToken;
+        ShardedMap<const Connection *, std::shared_ptr<Session>> byConnection;
+
+        // Writers update both indexes under this lock so they never disagree;
+        // lookups only take the shared lock of a single shard
+        std::mutex muxWriters;
+
+    public:
+        SessionStore() = default;
+        SessionStore(const SessionStore &) = delete;
+
+        // Binds the token to the connection, replacing any session either of
+        // them was previously part of. A token logged in again from another
+        // connection moves to the new connection. Returns null if the
+        // connection has already closed.
+        std::shared_ptr<Session> bind(const std::shared_ptr<Connection> &connection, Token token,
+                                      std::any data = {}) {
+            auto session = std::make_shared<Session>(Session{token, connection, std::move(data)});
+
+            // Connection::close() shuts the socket before its callback takes
+            // this lock, so a racing close is either seen here or unbinds after
+            std::scoped_lock lock(muxWriters);
+            if (!connection || !connection->isConnected()) {
+                return nullptr;
+            }
+            auto previousByConnection = byConnection.find(connection.get());
+            if (previousByConnection) {
+                byToken.erase((*previousByConnection)->token);
+            }
+            auto previousByToken = byToken.find(token);
+            if (previousByToken) {
+                byConnection.erase(previousByToken->connection);
+            }
+            byConnection.insert_or_assign(connection.get(), session);
+            byToken.insert_or_assign(token, Binding{connection.get(), session});
+            return session;
+        }
+
+        // Removes the session bound to the connection, if any
+        void unbind(const Connection *connection) {
+            std::scoped_lock lock(muxWriters);
+            auto session = byConnection.erase(connection);
+            if (session) {
+                byToken.erase((*session)->token);
+            }
+        }
+
+        void unbind(const std::shared_ptr<Connection> &connection) { unbind(connection.get()); }
+
+        std::shared_ptr<Session> find(const std::shared_ptr<Connection> &connection) const {
+            return byConnection.find(connection.get()).value_or(nullptr);
+        }
+
+        std::shared_ptr<Session> find(const Token &token) const {
+            auto binding = byToken.find(token);
+            return binding ? binding->session : nullptr;
+        }
+
+        size_t size() const { return byToken.size(); }
+
+        void clear() {
+            std::scoped_lock lock(muxWriters);
+            byConnection.clear();
+            byToken.clear();
+        }
+    };
+
+} // namespace meow::net
@@ -0,0 +1,113 @@
+// Sharded map
+// Defines a concurrent hash map split into independently locked shards.
+// Lookups take a shared lock on a single shard, so readers never contend
+// with each other and writers only block the shard their key hashes into.
+// ---------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace meow::net {
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>,
+              size_t Shards = 16>
+    class ShardedMap {
+        static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "Shard count must be a power of two");
+
+    protected:
+        // Each shard sits on its own cache line so neighbouring locks don't false share
+        struct alignas(64) Shard {
+            std::unordered_map<K, V, Hash, Equal> map;
+            mutable std::shared_mutex muxShard;
+        };
+
+        std::array<Shard, Shards> shards;
+        Hash hasher;
+
+        // Identity hashes (pointers, sequential ids) keep their entropy in the
+        // high bits, so run them through the murmur3 finalizer before masking
+        static size_t shard_index(size_t hash) {
+            uint64_t x = hash;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ULL;
+            x ^= x >> 33;
+            return static_cast<size_t>(x & (Shards - 1));
+        }
+
+        Shard &shard_for(const K &key) { return shards[shard_index(hasher(key))]; }
+        const Shard &shard_for(const K &key) const { return shards[shard_index(hasher(key))]; }
+
+    public:
+        ShardedMap() = default;
+        ShardedMap(const ShardedMap &) = delete;
+
+        std::optional<V> find(const K &key) const {
+            auto &shard = shard_for(key);
+            std::shared_lock lock(shard.muxShard);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        bool contains(const K &key) const {
+            auto &shard = shard_for(key);
+            std::shared_lock lock(shard.muxShard);
+            return shard.map.find(key) != shard.map.end();
+        }
+
+        // Inserts or replaces the value, returning the previous one if there was any
+        std::optional<V> insert_or_assign(const K &key, V value) {
+            auto &shard = shard_for(key);
+            std::unique_lock lock(shard.muxShard);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end()) {
+                shard.map.emplace(key, std::move(value));
+                return std::nullopt;
+            }
+            auto previous = std::move(it->second);
+            it->second = std::move(value);
+            return previous;
+        }
+
+        std::optional<V> erase(const K &key) {
+            auto &shard = shard_for(key);
+            std::unique_lock lock(shard.muxShard);
+            auto it = shard.map.find(key);
+            if (it == shard.map.end()) {
+                return std::nullopt;
+            }
+            auto previous = std::move(it->second);
+            shard.map.erase(it);
+            return previous;
+        }
+
+        size_t size() const {
+            size_t count = 0;
+            for (auto &shard : shards) {
+                std::shared_lock lock(shard.muxShard);
+                count += shard.map.size();
+            }
+            return count;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        void clear() {
+            for (auto &shard : shards) {
+                std::unique_lock lock(shard.muxShard);
+                shard.map.clear();
+            }
+        }
+    };
+
+} // namespace meow::net
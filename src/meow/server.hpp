@@ -19,6 +19,7 @@ namespace meow::net {
 
         TSQueue<OwnedMessage<MessageId>> msgInQueue;
         std::deque<std::shared_ptr<Connection>> connections;
+        SessionStore sessions;
 
     public:
         Server(const uint16_t port)
@@ -52,6 +53,8 @@ namespace meow::net {
                     std::cout << "[Info] New connection: " << socket.remote_endpoint() << std::endl;
                     auto new_connection = std::make_shared<Connection>(Connection::Owner::Server, io_context,
                                                                        std::move(socket), msgInQueue);
+                    new_connection->set_on_close(
+                        [this](const Connection *connection) { unbindSession(connection); });
                     connections.emplace_back(std::move(new_connection));
                     connections.back()->connect_to_client();
                     
@@ -66,12 +69,31 @@ namespace meow::net {
             if (client && client->isConnected()) {
                 client->send(message);
             } else {
-                client.reset();
+                unbindSession(client);
                 connections.erase(std::remove(connections.begin(), connections.end(), client),
                                   connections.end());
+                client.reset();
             }
         }
 
+        // Binds an authenticated token and its session data to the connection.
+        // Call this from the login handler once the token has been accepted.
+        // Returns null if the connection closed before the login was handled.
+        std::shared_ptr<Session> bindSession(std::shared_ptr<Connection> client, Token token,
+                                             std::any data = {}) {
+            return sessions.bind(std::move(client), token, std::move(data));
+        }
+
+        void unbindSession(const std::shared_ptr<Connection> &client) { sessions.unbind(client); }
+
+        void unbindSession(const Connection *client) { sessions.unbind(client); }
+
+        std::shared_ptr<Session> getSession(const std::shared_ptr<Connection> &client) const {
+            return sessions.find(client);
+        }
+
+        std::shared_ptr<Session> getSession(const Token &token) const { return sessions.find(token); }
+
         void update(size_t maxMessages = -1, bool wait = false) {
             if (wait) {
                 msgInQueue.wait();
@@ -79,7 +101,7 @@ namespace meow::net {
             size_t messageCount = 0;
             while (messageCount < maxMessages && !msgInQueue.empty()) {
                 auto msg = msgInQueue.pop_front();
-                onMessage(msg.remote, msg.message);
+                onSessionMessage(msg.remote, getSession(msg.remote), msg.message);
                 messageCount++;
             }
         }
@@ -87,5 +109,11 @@ namespace meow::net {
         virtual void onMessage(std::shared_ptr<Connection> client, Message<MessageId> &msg) {
             std::cout << "[DEBUG] This should be overrided" << std::endl;
         }
+
+        // Session is null until the connection has been bound with bindSession
+        virtual void onSessionMessage(std::shared_ptr<Connection> client, std::shared_ptr<Session>,
+                                      Message<MessageId> &msg) {
+            onMessage(client, msg);
+        }
     };
 } // namespace meow::net
\ No newline at end of file
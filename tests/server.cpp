@@ -4,17 +4,10 @@
 
 namespace catnest {
     using namespace meow::net;
-    struct Hasher {
-        size_t operator()(const Token &token) const { return std::hash<uint64_t>()(token.value); }
-    };
-
-    struct Equal {
-        bool operator()(const Token &lhs, const Token &rhs) const { return lhs.value == rhs.value; }
-    };
 
     class Catnest : public Server {
 
-        std::unordered_map<Token, std::string, Hasher, Equal> profiles;
+        std::unordered_map<Token, std::string, TokenHash> profiles;
 
     public:
         Catnest(const uint16_t port) : Server(port) {}
@@ -22,18 +15,26 @@ namespace catnest {
 
         void test_setup();
 
-        void onMessage(std::shared_ptr<Connection> client, Message<MessageId> &msg) override {
+        void onSessionMessage(std::shared_ptr<Connection> client, std::shared_ptr<Session> session,
+                              Message<MessageId> &msg) override {
             switch (msg.header.id) {
             case MessageId::Login: {
                 std::cout << "[Info] Login request" << std::endl;
                 Token token;
                 read_data(msg, 0, token);
                 std::cout << "[Info] Token: " << token.value << std::endl;
+                auto profile = profiles.find(token);
+                bindSession(client, token, profile != profiles.end() ? profile->second : std::string());
                 Message<MessageId> response;
                 response.header.id = MessageId::Accept;
                 sendMessage(client, response);
                 break;
             }
+            case MessageId::Logout: {
+                std::cout << "[Info] Logout request" << std::endl;
+                unbindSession(client);
+                break;
+            }
             case MessageId::Message: {
                 std::cout << "[Info] Message request" << std::endl;
                 std::string message = "";
@@ -53,10 +54,13 @@ namespace catnest {
             }
             case MessageId::Profile: {
                 std::cout << "[Info] Profile request" << std::endl;
-                Token token;
-                read_data(msg, 0, token);
-                std::cout << "[Info] Token: " << token.value << std::endl;
-                auto profile = profiles[token];
+                std::string profile = "";
+                if (!session) {
+                    std::cout << "[ERROR] Profile request before login" << std::endl;
+                } else if (auto data = session->get<std::string>()) {
+                    std::cout << "[Info] Token: " << session->token.value << std::endl;
+                    profile = *data;
+                }
                 std::cout << "[Info] Profile: " << profile << std::endl;
                 Message<MessageId> response;
                 response.header.id = MessageId::Profile;
@@ -66,6 +70,8 @@ namespace catnest {
                 sendMessage(client, response);
                 break;
             }
+            default:
+                break;
             }
         }
     };
@@ -0,0 +1,225 @@
+#include <meow.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace meow::net;
+
+#define CHECK(cond)                                                                                          \
+    do {                                                                                                     \
+        if (!(cond)) {                                                                                       \
+            std::cerr << "[FAIL] " << __FILE__ << ":" << __LINE__ << ": " #cond << std::endl;                \
+            std::exit(1);                                                                                    \
+        }                                                                                                    \
+    } while (0)
+
+// Exposes the shard a key lands in so the spread can be checked
+template <typename K>
+struct ShardProbe : ShardedMap<K, int> {
+    size_t index_of(const K &key) const { return this->shard_index(this->hasher(key)); }
+};
+
+struct Fixture {
+    asio::io_context io_context;
+    TSQueue<OwnedMessage<MessageId>> msgInQueue;
+
+    // Sessions only bind to open sockets, so hand out opened but unconnected ones
+    std::shared_ptr<Connection> connection() {
+        return std::make_shared<Connection>(Connection::Owner::Server, io_context,
+                                            asio::ip::tcp::socket(io_context, asio::ip::tcp::v4()), msgInQueue);
+    }
+};
+
+void test_shard_spread(Fixture &fixture) {
+    ShardProbe<const Connection *> pointers;
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::set<size_t> used;
+    for (int i = 0; i < 1000; i++) {
+        connections.emplace_back(std::make_shared<Connection>(Connection::Owner::Server, fixture.io_context,
+                                                              asio::ip::tcp::socket(fixture.io_context),
+                                                              fixture.msgInQueue));
+        used.insert(pointers.index_of(connections.back().get()));
+    }
+    CHECK(used.size() == 16);
+
+    ShardProbe<uint64_t> ids;
+    used.clear();
+    for (uint64_t i = 0; i < 1000; i++) {
+        used.insert(ids.index_of(i * 16));
+    }
+    CHECK(used.size() == 16);
+}
+
+void test_sharded_map() {
+    ShardedMap<uint64_t, std::string> map;
+    CHECK(map.empty());
+    CHECK(!map.insert_or_assign(1, "one"));
+    CHECK(map.insert_or_assign(1, "uno").value() == "one");
+    CHECK(map.find(1).value() == "uno");
+    CHECK(map.contains(1) && !map.contains(2));
+    CHECK(map.erase(1).value() == "uno");
+    CHECK(!map.erase(1));
+    CHECK(map.size() == 0);
+}
+
+void test_bind_and_find(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    auto session = store.bind(a, Token{1}, std::string("cat"));
+    CHECK(store.find(a) == session);
+    CHECK(store.find(Token{1}) == session);
+    CHECK(*session->get<std::string>() == "cat");
+    CHECK(session->get<int>() == nullptr);
+    CHECK(session->connection.lock() == a);
+}
+
+void test_rebind_token_to_other_connection(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    auto b = fixture.connection();
+    store.bind(a, Token{1});
+    auto session = store.bind(b, Token{1});
+    CHECK(store.find(a) == nullptr);
+    CHECK(store.find(b) == session);
+    CHECK(store.find(Token{1}) == session);
+    CHECK(store.size() == 1);
+}
+
+void test_rebind_connection_to_other_token(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    store.bind(a, Token{1});
+    auto session = store.bind(a, Token{2});
+    CHECK(store.find(Token{1}) == nullptr);
+    CHECK(store.find(Token{2}) == session);
+    CHECK(store.find(a) == session);
+    CHECK(store.size() == 1);
+}
+
+void test_unbind(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    auto b = fixture.connection();
+    store.bind(a, Token{1});
+    store.bind(b, Token{2});
+    store.unbind(a);
+    CHECK(store.find(a) == nullptr);
+    CHECK(store.find(Token{1}) == nullptr);
+    CHECK(store.find(Token{2}) != nullptr);
+
+    // Unbinding by raw pointer still works once the connection is gone
+    const Connection *key = b.get();
+    auto session = store.find(b);
+    b.reset();
+    CHECK(session->connection.expired());
+    store.unbind(key);
+    CHECK(store.find(Token{2}) == nullptr);
+    CHECK(store.size() == 0);
+}
+
+void test_unbind_on_close(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    store.bind(a, Token{1});
+
+    // The read and write handlers close the socket through the same path on error
+    auto b = fixture.connection();
+    store.bind(b, Token{2});
+    b->set_on_close([&store](const Connection *connection) { store.unbind(connection); });
+    b->disconnect();
+    fixture.io_context.restart();
+    fixture.io_context.run();
+    CHECK(!b->isConnected());
+    CHECK(store.find(b) == nullptr);
+    CHECK(store.find(Token{2}) == nullptr);
+    CHECK(store.find(Token{1}) != nullptr);
+}
+
+void test_bind_after_close(Fixture &fixture) {
+    SessionStore store;
+    auto a = fixture.connection();
+    a->set_on_close([&store](const Connection *connection) { store.unbind(connection); });
+
+    // A login still queued when the socket closed must not leave a session behind
+    a->disconnect();
+    fixture.io_context.restart();
+    fixture.io_context.run();
+    CHECK(store.bind(a, Token{1}) == nullptr);
+    CHECK(store.find(a) == nullptr);
+    CHECK(store.find(Token{1}) == nullptr);
+    CHECK(store.size() == 0);
+}
+
+void test_concurrent_bind_find(Fixture &fixture) {
+    SessionStore store;
+    std::vector<std::shared_ptr<Connection>> connections;
+    for (int i = 0; i < 8; i++) {
+        connections.emplace_back(fixture.connection());
+    }
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; w++) {
+        writers.emplace_back([&, w]() {
+            for (uint64_t i = 0; i < 20000; i++) {
+                auto &connection = connections[(i + w) % connections.size()];
+                if (i % 7 == 0) {
+                    store.unbind(connection);
+                } else {
+                    store.bind(connection, Token{(i * 31 + w) % 12});
+                }
+            }
+        });
+    }
+    std::thread reader([&]() {
+        while (!done) {
+            for (uint64_t t = 0; t < 12; t++) {
+                auto session = store.find(Token{t});
+                if (session) {
+                    CHECK(session->token == Token{t});
+                }
+            }
+        }
+    });
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    // Once writers are quiescent both indexes must agree
+    size_t bound = 0;
+    for (auto &connection : connections) {
+        auto session = store.find(connection);
+        if (session) {
+            CHECK(session->connection.lock() == connection);
+            CHECK(store.find(session->token) == session);
+            bound++;
+        }
+    }
+    for (uint64_t t = 0; t < 12; t++) {
+        auto session = store.find(Token{t});
+        if (session) {
+            CHECK(store.find(session->connection.lock()) == session);
+        }
+    }
+    CHECK(store.size() == bound);
+}
+
+int main() {
+    Fixture fixture;
+    test_shard_spread(fixture);
+    test_sharded_map();
+    test_bind_and_find(fixture);
+    test_rebind_token_to_other_connection(fixture);
+    test_rebind_connection_to_other_token(fixture);
+    test_unbind(fixture);
+    test_unbind_on_close(fixture);
+    test_bind_after_close(fixture);
+    test_concurrent_bind_find(fixture);
+    std::cout << "[Info] Session tests passed" << std::endl;
+    return 0;
+}